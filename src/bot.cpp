@@ -0,0 +1,89 @@
+#include "bot.hpp"
+#include "game.hpp"
+
+
+int Bot::predict(const Predictor& predictor) const {
+    const auto& row = counts[predictor.offset + predictor.context];
+    int best = -1;
+    unsigned best_count = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (row[i] > best_count) {
+            best = i;
+            best_count = row[i];
+        }
+    }
+    return best;
+}
+
+Bot::Bot(): random(std::random_device()()) {
+    unsigned offset = 0;
+    for (unsigned i = 0; i < predictor_count; ++i) {
+        predictors[i].offset = offset;
+        predictors[i].base = layout[i][0];
+        predictors[i].contexts = layout[i][1];
+        offset += layout[i][1];
+    }
+    reset();
+}
+
+void Bot::reset() {
+    for (auto& row : counts) {
+        row[0] = row[1] = row[2] = 0;
+    }
+    for (auto& predictor : predictors) {
+        predictor.context = 0;
+        predictor.prediction = -1;
+        predictor.score = 0;
+    }
+}
+
+Choice Bot::choose() {
+    // Pick the highest scoring predictor, breaking ties at random
+    const Predictor* best = nullptr;
+    unsigned ties = 0;
+    for (const auto& predictor : predictors) {
+        if (predictor.prediction == -1) {
+            continue;
+        }
+        if (best == nullptr || predictor.score > best->score) {
+            best = &predictor;
+            ties = 1;
+        }
+        else if (predictor.score == best->score && random() % ++ties == 0) {
+            best = &predictor;
+        }
+    }
+    // Play at random without a confident prediction, and sometimes anyway so
+    // that the bot can't be predicted by a copy of itself
+    if (best == nullptr || best->score < confidence || random() % random_rate == 0) {
+        return static_cast<Choice>(random() % 3);
+    }
+    // Play the choice that beats the prediction
+    return static_cast<Choice>((best->prediction + 1) % 3);
+}
+
+void Bot::update(Choice user, Choice opponent) {
+    auto u = static_cast<unsigned>(user), o = static_cast<unsigned>(opponent);
+    if (u > 2 || o > 2) {
+        return;
+    }
+    for (auto& predictor : predictors) {
+        // Decay old results so the ensemble follows opponent's strategy changes
+        predictor.score -= predictor.score >> 3;
+        if (predictor.prediction == static_cast<int>(o)) {
+            predictor.score += 32;
+        }
+
+        // Halve the counts before they overflow, favouring recent rounds
+        auto& row = counts[predictor.offset + predictor.context];
+        if (++row[o] == UINT8_MAX) {
+            row[0] >>= 1;
+            row[1] >>= 1;
+            row[2] >>= 1;
+        }
+
+        auto symbol = predictor.base == 3 ? o : 3 * u + o;
+        predictor.context = (predictor.context * predictor.base + symbol) % predictor.contexts;
+        predictor.prediction = predict(predictor);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+enum class Choice; // Defined in game.hpp
+
+// Adaptive rock paper scissors player
+//
+// Keeps n-gram statistics over opponent's choices and Markov statistics over
+// both players' choices. Each predictor guesses opponent's next choice from
+// its own count table, and the bot counters the guess of the predictor that
+// has been most accurate recently. Both choose() and update() are O(1) and
+// all counts live in a single flat table of a few hundred bytes.
+class Bot {
+    // Counts of opponent's choices following a context
+    using Counts = std::uint8_t[3];
+
+    // Predicts opponent's choice from the last few rounds
+    struct Predictor {
+        unsigned offset;        // Index of the first context in counts
+        unsigned contexts;      // Number of contexts, 3^order or 9^order
+        unsigned base;          // 3 for opponent's choices, 9 for both players' choices
+        unsigned context = 0;   // Current context
+        int prediction = -1;    // Predicted choice, -1 if there is no data
+        unsigned score = 0;     // Exponentially decaying number of correct predictions
+    };
+
+    // Order 0-3 n-grams over opponent's choices, order 1-2 Markov chains over
+    // both players' choices
+    static const unsigned predictor_count = 6;
+
+    // Base and number of contexts of each predictor
+    static constexpr unsigned layout[predictor_count][2] = {
+        {3, 1}, {3, 3}, {3, 9}, {3, 27},
+        {9, 9}, {9, 81},
+    };
+
+    // Total number of contexts of all predictors
+    static constexpr unsigned context_count = [] {
+        unsigned n = 0;
+        for (const auto& l : layout) {
+            n += l[1];
+        }
+        return n;
+    }();
+
+    // Minimum score of a predictor worth following. A predictor that is right
+    // 1/3 of the time, like guessing, settles at a score of about 85.
+    static const unsigned confidence = 96;
+
+    // One in random_rate choices is random regardless of the predictions
+    static const unsigned random_rate = 16;
+
+    Predictor predictors[predictor_count];
+    Counts counts[context_count];
+    std::minstd_rand random;
+
+    // Opponent's most likely choice in context, -1 if there is no data
+    int predict(const Predictor& predictor) const;
+public:
+    // Initialize a bot without any statistics
+    Bot();
+
+    // Forget all statistics, e.g. when playing a new opponent
+    void reset();
+
+    // Choose user's next choice
+    Choice choose();
+
+    // Record a finished round
+    void update(Choice user, Choice opponent);
+};
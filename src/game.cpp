@@ -66,16 +66,37 @@ inline bool Game::check(State condition) {
 
 void Game::run_server() {
     Event event;
-    server = std::make_unique<Server>(server_port);
-    server->listen();
-    while (true) {
-        auto connection = server->accept();
+    {
+        std::lock_guard lock(sockets_m);
+        if (stopping) {
+            return;
+        }
+        server = std::make_unique<Server>(server_port);
+        server->listen();
+    }
+    while (!stopping) {
+        std::unique_ptr<Connection> connection;
+        try {
+            connection = server->accept();
+        } catch (const std::runtime_error& e) {
+            if (stopping) {
+                break;
+            }
+            throw;
+        }
+        {
+            std::lock_guard lock(sockets_m);
+            if (stopping) {
+                break;
+            }
+            server_connection = std::move(connection);
+        }
         event.type = server_connected;
         event_queue.put(event);
 
         while (true) {
             Message message;
-            if (connection->recv(&message)) {
+            if (server_connection->recv(&message)) {
                 Event event;
                 event.type = message_received;
                 event.data.message = message;
@@ -84,6 +105,10 @@ void Game::run_server() {
                 break;
             }
         }
+        {
+            std::lock_guard lock(sockets_m);
+            server_connection.reset();
+        }
         event.type = server_disconnected;
         event_queue.put(event);
     }
@@ -99,13 +124,21 @@ void Game::state_off(State conditions) {
 
 void Game::run_client() {
     Event event;
-    while (true) {
+    while (!stopping) {
+        std::unique_ptr<Connection> connection;
         try {
-            client = std::make_unique<Connection>(client_host, client_port);
+            connection = std::make_unique<Connection>(client_host, client_port);
         } catch (const ConnectionError& e) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
             continue;
         }
+        {
+            std::lock_guard lock(sockets_m);
+            if (stopping) {
+                break;
+            }
+            client = std::move(connection);
+        }
         event.type = client_connected;
         event_queue.put(event);
 
@@ -122,6 +155,8 @@ void Game::run_client() {
             outgoing_messages.put(std::nullopt);
         });
 
+        // Ends when the connection closes or when stop() has been called,
+        // in which case all the queued messages are sent first
         for (std::optional<Message> message; message = outgoing_messages.get();) {
             try {
                 client->send(&message.value());
@@ -129,6 +164,7 @@ void Game::run_client() {
                 break;
             }
         }
+        client->shutdown(); // Wake up client_recv_thread
         client_recv_thread.join();
         outgoing_messages.clear();
         event.type = client_disconnected;
@@ -140,11 +176,13 @@ void Game::run_ui() {
     std::string s;
     Event event;
     event.type = user_choice;
-    while (true) {
-        std::cin >> s;
+    while (std::cin >> s) {
         event.data.choice = to_choice(s);
         event_queue.put(event);
     }
+    // End of input
+    ui_finished = true;
+    quit();
 }
 
 void Game::reveal() {
@@ -155,13 +193,63 @@ void Game::reveal() {
     state_on(condition_user_revealed);
 }
 
-Game::Game(const char *server_port, const char *client_host, const char *client_port):
+void Game::prompt() {
+    std::cout << "Make a choice: " << std::flush;
+    if (bot) {
+        Event event;
+        event.type = user_choice;
+        event.data.choice = bot->choose();
+        std::cout << event.data.choice << std::endl;
+        event_queue.put(event);
+    }
+}
+
+Game::Game(const char *server_port, const char *client_host, const char *client_port, bool use_bot):
     server_port(server_port),
     client_host(client_host),
-    client_port(client_port) {}
+    client_port(client_port),
+    bot(use_bot ? std::make_unique<Bot>() : nullptr) {}
+
+void Game::stop() {
+    stopping = true;
+
+    // Let run_client() send the queued messages, e.g. user's reveal, before
+    // it closes the connection. The opponent must not see the other
+    // connection close first, or it could drop the round before reading them.
+    outgoing_messages.put(std::nullopt);
+    client_thread.join();
+
+    {
+        std::lock_guard lock(sockets_m);
+        if (server) {
+            server->shutdown();
+        }
+        if (server_connection) {
+            server_connection->shutdown();
+        }
+    }
+    server_thread.join();
+    if (ui_thread.joinable()) {
+        if (ui_finished) {
+            ui_thread.join();
+        }
+        else {
+            // std::cin can't be interrupted, the thread is left blocked until exit
+            ui_thread.detach();
+        }
+    }
+}
+
+void Game::quit() {
+    Event event;
+    event.type = quit_requested;
+    event_queue.put(event);
+}
 
 void Game::run() {
-    ui_thread = std::thread(&Game::run_ui, this);
+    if (!bot) {
+        ui_thread = std::thread(&Game::run_ui, this);
+    }
     server_thread = std::thread(&Game::run_server, this);
     client_thread = std::thread(&Game::run_client, this);
     std::cout << "Connecting..." << std::endl;
@@ -175,12 +263,18 @@ void Game::run() {
                 state_on(condition_server_connected);
             }
             if (check(condition_client_connected | condition_server_connected)) {
-                std::cout << "Connected.\n\nMake a choice: " << std::flush;
+                std::cout << "Connected.\n" << std::endl;
+                prompt();
             }
         }
         else if (event.type == client_disconnected || event.type == server_disconnected) {
             if (check(condition_client_connected | condition_server_connected)) {
-                std::cout << "\nDisconnected, reconnecting..." << std::endl;
+                if (draining) {
+                    std::cout << "\nDisconnected, quitting..." << std::endl;
+                }
+                else {
+                    std::cout << "\nDisconnected, reconnecting..." << std::endl;
+                }
             }
             state &= condition_client_connected | condition_server_connected;
             if (event.type == client_disconnected) {
@@ -189,13 +283,20 @@ void Game::run() {
             else {
                 state_off(condition_server_connected);
             }
+            if (draining) {
+                stop();
+                return;
+            }
             // Reset 
             wins = losses = 0;
+            if (bot) {
+                bot->reset();
+            }
         }
         else if (event.type == user_choice) {
             if (check(condition_client_connected | condition_server_connected) && !check(condition_user_choice_made)) {
                 if (event.data.choice == Choice::invalid) {
-                    std::cout << "Make a choice: " << std::flush;
+                    prompt();
                     continue;
                 }
                 user_choice_reveal = ChoiceReveal(event.data.choice);
@@ -236,6 +337,9 @@ void Game::run() {
                 else {
                     // Hash valid
                     std::cout << "Opponent's choice: " << opponent_choice_reveal.choice << std::endl;
+                    if (bot) {
+                        bot->update(user_choice_reveal.choice, opponent_choice_reveal.choice);
+                    }
                     int d = (3 + static_cast<int>(user_choice_reveal.choice) - static_cast<int>(opponent_choice_reveal.choice)) % 3;
                     if (d == 1) {
                         std::cout << "YOU WIN!" << std::endl;
@@ -251,9 +355,25 @@ void Game::run() {
                 }
                 std::cout << "Score: " << wins << " - " << losses << '\n' << std::endl;
 
+                if (draining) {
+                    stop();
+                    return;
+                }
+
                 // Next round
                 state = condition_client_connected | condition_server_connected;
-                std::cout << "Make a choice: " << std::flush;
+                prompt();
+            }
+        }
+        else if (event.type == quit_requested) {
+            // Wait for opponent's reveal if both choices have been announced
+            if (check(condition_user_revealed) && !draining) {
+                std::cout << "\nFinishing the current round..." << std::endl;
+                draining = true;
+            }
+            else {
+                stop();
+                return;
             }
         }
     }
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <optional>
 #include "network.hpp"
 #include "queue.hpp"
+#include "bot.hpp"
 
 #define SHA256 1
 #define SHA512 2
@@ -71,6 +73,7 @@ enum EventType {
     client_disconnected,
     user_choice,
     message_received,
+    quit_requested,
 };
 
 // Events sent to Game::run()
@@ -94,9 +97,15 @@ class Game {
     State state = 0; // Current state
 
     const char *server_port, *client_host, *client_port;
-    std::unique_ptr<Server> server;     // Server for incoming messages
-    std::unique_ptr<Connection> client; // Connection for outgoing messages
+    std::unique_ptr<Server> server;                 // Server for incoming messages
+    std::unique_ptr<Connection> server_connection;  // Connection accepted by server
+    std::unique_ptr<Connection> client;             // Connection for outgoing messages
+    std::mutex sockets_m;                           // Guards server, server_connection and client
+    std::atomic<bool> stopping = false;             // Set when server and client threads should exit
+    bool draining = false;                          // Quit after the current round
+    std::atomic<bool> ui_finished = false;          // Set when run_ui() has reached end of input
     std::thread server_thread, client_thread, ui_thread;
+    std::unique_ptr<Bot> bot;                       // Makes user's choices if not nullptr
 
     Queue<Event> event_queue;                           // Events handled by Game::run()
     Queue<std::optional<Message>> outgoing_messages;    // Messages to sent to opponent by Game::run_client()
@@ -126,10 +135,20 @@ class Game {
 
     // Reveal user's choice
     void reveal();
+
+    // Ask the user, or the bot, to make a choice
+    void prompt();
+
+    // Close all sockets and join server and client threads
+    void stop();
 public:
-    // Initialize a game
-    Game(const char *server_port, const char *client_host, const char *client_port);
+    // Initialize a game, played by a bot if use_bot is true
+    Game(const char *server_port, const char *client_host, const char *client_port, bool use_bot = false);
 
-    // Play the game
+    // Play the game until quit() is called
     void run();
+
+    // Ask run() to return once the current round is finished, or right away
+    // if called twice. Thread safe.
+    void quit();
 };
\ No newline at end of file
@@ -1,12 +1,39 @@
 #include <iostream>
+#include <cstring>
+#include <csignal>
+#include <thread>
+#include <pthread.h>
 #include "game.hpp"
 
 int main(int argc, char** argv) {
-    if (argc != 4) {
-        std::cout << "Usage: ./rock_paper_scissors <your port> <opponent's host> <opponent's port>\n";
+    // Let a bot play instead of the user
+    bool use_bot = argc > 1 && std::strcmp(argv[1], "--bot") == 0;
+    if (argc != 4 + use_bot) {
+        std::cout << "Usage: ./rock_paper_scissors [--bot] <your port> <opponent's host> <opponent's port>\n";
         return 1;
     }
-    Game game(argv[1], argv[2], argv[3]);
+
+    // Block SIGINT and SIGTERM in all threads, they are handled by
+    // signal_thread instead
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    Game game(argv[1 + use_bot], argv[2 + use_bot], argv[3 + use_bot], use_bot);
+    std::atomic<bool> done = false;
+    std::thread signal_thread([&]() {
+        int signal;
+        while (sigwait(&signals, &signal) == 0 && !done) {
+            game.quit();
+        }
+    });
     game.run();
+
+    // Wake up signal_thread so it can be joined
+    done = true;
+    pthread_kill(signal_thread.native_handle(), SIGTERM);
+    signal_thread.join();
     return 0;
 }
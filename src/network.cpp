@@ -2,6 +2,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <cstring>
 #include "util.hpp"
 
@@ -14,6 +16,37 @@ BrokenPipe::BrokenPipe(): std::runtime_error("broken pipe") {
 };
 
 
+bool connect_with_timeout(int socket_fd, const sockaddr* addr, socklen_t addrlen, int timeout) {
+    // Connect in non-blocking mode so that unreachable hosts time out quickly
+    int flags = fcntl(socket_fd, F_GETFL);
+    if (flags == -1 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        throw std::runtime_error(strerror("fcntl"));
+    }
+    if (::connect(socket_fd, addr, addrlen) == -1) {
+        if (errno != EINPROGRESS) {
+            return false;
+        }
+        pollfd pfd = {socket_fd, POLLOUT, 0};
+        if (int n = poll(&pfd, 1, timeout); n == -1) {
+            throw std::runtime_error(strerror("poll"));
+        } else if (n == 0) {
+            return false; // Timed out
+        }
+        int error;
+        socklen_t error_len = sizeof(error);
+        if (getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &error, &error_len) == -1) {
+            throw std::runtime_error(strerror("getsockopt"));
+        }
+        if (error != 0) {
+            return false;
+        }
+    }
+    if (fcntl(socket_fd, F_SETFL, flags) == -1) {
+        throw std::runtime_error(strerror("fcntl"));
+    }
+    return true;
+}
+
 void init(const char* host, const char* port, int& socket_fd, sockaddr_storage& addr) {
     addrinfo hints = {};
     hints.ai_family = AF_UNSPEC;        // Use IPv4 or IPv6
@@ -55,7 +88,7 @@ void init(const char* host, const char* port, int& socket_fd, sockaddr_storage&
             }
         }
         else { // For client only
-            if (connect(socket_fd, p->ai_addr, p->ai_addrlen) == -1) {
+            if (!connect_with_timeout(socket_fd, p->ai_addr, p->ai_addrlen, CONNECT_TIMEOUT)) {
                 if (close(socket_fd) == -1) {
                     std::cerr << strerror("close") << '\n';
                 }
@@ -89,6 +122,13 @@ Connection::~Connection() {
     }
 }
 
+void Connection::shutdown() {
+    // ENOTCONN - the remote side has already closed the connection
+    if (::shutdown(socket_fd, SHUT_RDWR) == -1 && errno != ENOTCONN) {
+        std::cerr << strerror("shutdown") << '\n';
+    }
+}
+
 void Connection::send(const char* buf, const size_t len) {
     size_t sent = 0; // Bytes sent counter
     while(sent < len) {
@@ -128,3 +168,10 @@ std::unique_ptr<Connection> Server::accept() {
     }
     return std::make_unique<Connection>(peer_socket_fd, peer_addr);
 }
+
+void Server::shutdown() {
+    // On Linux, shutting down a listening socket makes accept() fail with EINVAL
+    if (::shutdown(socket_fd, SHUT_RDWR) == -1 && errno != ENOTCONN) {
+        std::cerr << strerror("shutdown") << '\n';
+    }
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <memory>
 #include "util.hpp"
 
+#define CONNECT_TIMEOUT 2000 // Milliseconds to wait for a connection to opponent
+
 
 // Thrown when a connection to server fails
 class ConnectionError: public std::runtime_error {
@@ -19,6 +21,13 @@ public:
 };
 
 
+// Connect socket_fd to addr, waiting at most timeout milliseconds
+// Returns:
+//  - true if the connection was established
+//  - false if it was refused or timed out
+bool connect_with_timeout(int socket_fd, const sockaddr* addr, socklen_t addrlen, int timeout);
+
+
 // Initialize a TCP server/connection
 //  - if host == nullptr, initializes a TCP server that listens on localhost:port,
 //  - if host != nullptr, initializes a TCP connection to host:port
@@ -39,6 +48,9 @@ public:
     // Close socket
     ~Connection();
 
+    // Stop sending and receiving, wakes up threads blocked in recv()
+    void shutdown();
+
     // Send data out over a socket
     void send(const char* buf, const size_t len);
 
@@ -46,11 +58,14 @@ public:
     // memory representation across different platforms.
     // Returns:
     //  - true if the message was successfully read
-    //  - false if the remote side has closed the connection
+    //  - false if the remote side has closed or reset the connection
     template<typename T>
     bool recv(T* data) { // returns false 
         auto n = ::recv(socket_fd, data, sizeof(T), MSG_WAITALL);
         if (n == -1) {
+            if (errno == ECONNRESET) {
+                return false;
+            }
             throw std::runtime_error(strerror("recv"));
         }
         return n != 0;
@@ -82,4 +97,7 @@ public:
 
     // Accept one incoming connection
     std::unique_ptr<Connection> accept();
+
+    // Stop accepting connections, wakes up threads blocked in accept()
+    void shutdown();
 };